@@ -10,12 +10,20 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
-#if defined(LOG_WITH_PRINTF)
 #include <stdio.h>
-#endif //defined(LOG_WITH_PRINTF)
+
+#if defined(LOG_WITH_TRANSMIT_CALLBACK)
+#include <stdatomic.h>
+#endif //defined(LOG_WITH_TRANSMIT_CALLBACK)
 
 #define LOG_LEVEL_COUNT         6U
 
+#if defined(LOG_WITH_TRANSMIT_CALLBACK)
+#define LOG_MSG_BUFFER_LEN      LOG_TX_BUFFER_LEN
+#else
+#define LOG_MSG_BUFFER_LEN      LOG_PRINT_BUFFER_LEN
+#endif //defined(LOG_WITH_TRANSMIT_CALLBACK)
+
 #if defined(__APPLE__) || defined(_WIN32) || defined(__unix__)
 #define FORMAT_UNSIGNED_8_BIT           "%u"
 #define FORMAT_SIGNED_8_BIT             "%d"
@@ -64,6 +72,17 @@ typedef struct {
     const char * const level_str;
 } log_level_and_string_t;
 
+#if defined(LOG_WITH_TRANSMIT_CALLBACK)
+typedef struct {
+    logger_transmit_callback_t transmit;
+    char buffer[2][LOG_TX_BUFFER_LEN];
+    size_t fill_index;
+    size_t fill_len;
+    atomic_bool busy;
+    atomic_flag lock;
+} logger_tx_t;
+#endif //defined(LOG_WITH_TRANSMIT_CALLBACK)
+
 static const char LOG_ERROR_CHAR[]      = "[ERROR   ]: ";
 static const char LOG_WARNING_CHAR[]    = "[WARNING ]: ";
 static const char LOG_CRITICAL_CHAR[]   = "[CRITICAL]: ";
@@ -105,23 +124,186 @@ static const log_level_and_string_t log_level_and_string[LOG_LEVEL_COUNT] = {
     { .level = LOG_LEVEL_TRACE, .level_str = LOG_TRACE_CHAR }
 };
 
+#if defined(LOG_WITH_TRANSMIT_CALLBACK)
+static logger_tx_t logger_tx = {
+    .transmit = NULL,
+    .fill_index = 0U,
+    .fill_len = 0U,
+    .busy = false,
+    .lock = ATOMIC_FLAG_INIT
+};
+
+/**
+ * Hands the fill buffer to the transmit callback if no transfer is running.
+ * The caller must hold the lock.
+ */
+static bool tx_start(void)
+{
+    if (atomic_load(&logger_tx.busy) || logger_tx.fill_len == 0U || logger_tx.transmit == NULL)
+    {
+        return false;
+    }
+
+    const char *data = logger_tx.buffer[logger_tx.fill_index];
+    const size_t len = logger_tx.fill_len;
+
+    atomic_store(&logger_tx.busy, true);
+    logger_tx.fill_index ^= 1U;
+    logger_tx.fill_len = 0U;
+
+    if (logger_tx.transmit(data, len) != LOGGER_STATUS_OK)
+    {
+        // the data is dropped, the buffer is free again
+        atomic_store(&logger_tx.busy, false);
+    }
+
+    return true;
+}
+
+/**
+ * Releases the lock. A completion that happened while the lock was held could
+ * not start the next transfer, so this is done here.
+ */
+static void tx_unlock(void)
+{
+    for (;;)
+    {
+        atomic_flag_clear(&logger_tx.lock);
+
+        if (atomic_load(&logger_tx.busy) || atomic_flag_test_and_set(&logger_tx.lock))
+        {
+            return;
+        }
+
+        if (!tx_start())
+        {
+            atomic_flag_clear(&logger_tx.lock);
+            return;
+        }
+    }
+}
+
+static int tx_format(const char * restrict level_str,
+                     const char * restrict func,
+                     const char * restrict msg,
+                     va_list args)
+{
+    char *dest = &logger_tx.buffer[logger_tx.fill_index][logger_tx.fill_len];
+    const size_t remaining = LOG_TX_BUFFER_LEN - logger_tx.fill_len;
+
+    const int header_len = snprintf(dest, remaining, "%s%s: ", level_str, func);
+    if (header_len < 0 || (size_t)header_len >= remaining)
+    {
+        return -1;
+    }
+
+    const int msg_len = vsnprintf(dest + header_len, remaining - (size_t)header_len, msg, args);
+
+    if (msg_len < 0 || (size_t)msg_len >= remaining - (size_t)header_len)
+    {
+        return -1;
+    }
+
+    return header_len + msg_len;
+}
+
+static logger_status_t tx_write(const char * restrict level_str,
+                                const char * restrict func,
+                                const char * restrict msg,
+                                va_list args)
+{
+    LOG_TX_ENTER_CRITICAL();
+
+    // never wait here, the lock is only held by another log call or the completion hook
+    if (atomic_flag_test_and_set(&logger_tx.lock))
+    {
+        LOG_TX_EXIT_CRITICAL();
+        return LOGGER_BUSY;
+    }
+
+    if (logger_tx.transmit == NULL)
+    {
+        atomic_flag_clear(&logger_tx.lock);
+        LOG_TX_EXIT_CRITICAL();
+        return LOGGER_NULL_POINTER_ERROR;
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int written = tx_format(level_str, func, msg, args_copy);
+    va_end(args_copy);
+
+    // the fill buffer is full, retry in the empty one if it can be swapped
+    if (written < 0 && logger_tx.fill_len > 0U && tx_start())
+    {
+        va_copy(args_copy, args);
+        written = tx_format(level_str, func, msg, args_copy);
+        va_end(args_copy);
+    }
+
+    logger_status_t result = LOGGER_STATUS_OK;
+
+    if (written < 0)
+    {
+        result = (logger_tx.fill_len > 0U) ? LOGGER_BUSY : LOGGER_OVERFLOW;
+    }
+    else
+    {
+        logger_tx.fill_len += (size_t)written;
+        (void)tx_start();
+    }
+
+    tx_unlock();
+    LOG_TX_EXIT_CRITICAL();
+
+    return result;
+}
+
+logger_status_t logger_set_transmit_callback(const logger_transmit_callback_t transmit)
+{
+    if (transmit == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    if (atomic_flag_test_and_set(&logger_tx.lock))
+    {
+        return LOGGER_BUSY;
+    }
+
+    logger_tx.transmit = transmit;
+    tx_unlock();
+    return LOGGER_STATUS_OK;
+}
+
+void logger_transmit_complete(void)
+{
+    atomic_store(&logger_tx.busy, false);
+
+    // if a log call holds the lock it starts the next transfer itself
+    if (!atomic_flag_test_and_set(&logger_tx.lock))
+    {
+        (void)tx_start();
+        tx_unlock();
+    }
+}
+#endif //defined(LOG_WITH_TRANSMIT_CALLBACK)
+
 static logger_status_t print_log_msg(const log_level_and_string_t *log_config,
                                    const char * restrict func,
                                    const char * restrict msg,
-                                   const va_list args)
+                                   va_list args)
 {
     if (log_config == NULL || logger_conf.level < log_config->level)
     {
         return LOGGER_NULL_POINTER_ERROR;
     }
 
-    char buffer[LOG_PRINT_BUFFER_LEN] = { 0U };
-
     const size_t preamble_len = strlen(log_config->level_str);
     const size_t func_len = strlen(func);
     const size_t msg_len = strlen(msg);
 
-    if (preamble_len + func_len + msg_len  >= sizeof(buffer))
+    if (preamble_len + func_len + msg_len  >= LOG_MSG_BUFFER_LEN)
     {
         return LOGGER_OVERFLOW;
     }
@@ -129,12 +311,14 @@ static logger_status_t print_log_msg(const log_level_and_string_t *log_config,
     // +2 for ": " and +1 for null terminator
     const size_t complete_msg_len = preamble_len + func_len + 2 + msg_len + 1;
 
-    if (complete_msg_len >= sizeof(buffer))
+    if (complete_msg_len >= LOG_MSG_BUFFER_LEN)
     {
         return LOGGER_OVERFLOW;
     }
 
 #if defined(LOG_WITH_PRINTF)
+    char buffer[LOG_MSG_BUFFER_LEN] = { 0U };
+
     const int snprintf_result = snprintf(buffer, sizeof(buffer), "%s%s: %s", log_config->level_str, func, msg);
     if (snprintf_result < 0 || (size_t)snprintf_result >= sizeof(buffer))
     {
@@ -146,6 +330,12 @@ static logger_status_t print_log_msg(const log_level_and_string_t *log_config,
     {
         return LOGGER_PRINT_FAILED;
     }
+#elif defined(LOG_WITH_TRANSMIT_CALLBACK)
+    const logger_status_t tx_result = tx_write(log_config->level_str, func, msg, args);
+    if (tx_result != LOGGER_STATUS_OK)
+    {
+        return tx_result;
+    }
 #endif //defined(LOG_WITH_PRINTF)
 
     return LOGGER_STATUS_OK;
@@ -154,7 +344,7 @@ static logger_status_t print_log_msg(const log_level_and_string_t *log_config,
 static logger_status_t log_generic(const log_level_list_t level,
                                  const char * restrict func,
                                  const char * restrict msg,
-                                 const va_list args)
+                                 va_list args)
 {
     const logger_status_t result = print_log_msg(&log_level_and_string[level], func, msg, args);
     return result;
@@ -335,7 +525,7 @@ logger_status_t log_array(const char *restrict func, const log_level_list_t leve
     }
 
     const size_t num_elements = array_size / info->element_size;
-    char buffer[LOG_PRINT_BUFFER_LEN] = { 0 };
+    char buffer[LOG_MSG_BUFFER_LEN] = { 0 };
     int offset = 0;
 
     for (size_t i = 0; i < num_elements; i++) {
@@ -20,7 +20,8 @@ typedef enum {
     LOGGER_OVERFLOW,
     LOGGER_FORMAT_ERROR,
     LOGGER_PRINT_FAILED,
-    LOGGER_WRONG_INPUT_PARAMETER
+    LOGGER_WRONG_INPUT_PARAMETER,
+    LOGGER_BUSY             /**< Both transmit buffers are in use or another log call holds the transmit buffer */
 }logger_status_t;
 
 /**
@@ -63,6 +64,37 @@ typedef enum {
     DOUBLE    /**<  Double */
 } log_format_t;
 
+#if defined(LOG_WITH_TRANSMIT_CALLBACK)
+/**
+ * @brief Callback to start a non-blocking transmission.
+ *
+ * Must only start the transfer (e.g. UART DMA) and return immediately. The
+ * buffer stays valid until logger_transmit_complete() is called.
+ *
+ * @param data Pointer to the data to transmit.
+ * @param len Number of bytes to transmit.
+ * @return LOGGER_STATUS_OK if the transfer was started, otherwise an error status.
+ */
+typedef logger_status_t (*logger_transmit_callback_t)(const char *data, size_t len);
+
+/**
+ * @brief Registers the transmit callback.
+ *
+ * @param transmit The callback to start a transmission.
+ * @return LOGGER_STATUS_OK on success, otherwise an error status.
+ */
+logger_status_t logger_set_transmit_callback(logger_transmit_callback_t transmit);
+
+/**
+ * @brief Completion hook for the transmit callback.
+ *
+ * Call this when the transfer started by the transmit callback is finished,
+ * e.g. from the DMA transfer complete interrupt. Starts the next buffer if
+ * data is pending.
+ */
+void logger_transmit_complete(void);
+#endif //defined(LOG_WITH_TRANSMIT_CALLBACK)
+
 /**
  * @brief Sets the log level for the logger.
  *
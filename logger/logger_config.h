@@ -38,12 +38,73 @@ extern "C" {
  */
 #define LOG_PRINT_BUFFER_LEN    UINT16_MAX
 
+/**
+ * @brief Log with transmit callback
+ *
+ * Alternative to LOG_WITH_PRINTF for UART/DMA targets. The logger fills one
+ * static buffer while the other one is handed to the registered transmit
+ * callback. Only one output may be selected.
+ */
+// #define LOG_WITH_TRANSMIT_CALLBACK
+
 /**
  * @brief Log with printf
  *
- * use printf for the output log
+ * use printf for the output log if no other output is selected
  */
+#if !defined(LOG_WITH_TRANSMIT_CALLBACK)
 #define LOG_WITH_PRINTF
+#endif // !defined(LOG_WITH_TRANSMIT_CALLBACK)
+
+/**
+ * @brief Transmit Buffer
+ *
+ * Size of each of the two static transmit buffers used with
+ * LOG_WITH_TRANSMIT_CALLBACK. A single log message must fit into one buffer.
+ */
+#if !defined(LOG_TX_BUFFER_LEN)
+#define LOG_TX_BUFFER_LEN       512U
+#endif // !defined(LOG_TX_BUFFER_LEN)
+
+/**
+ * @brief Transmit Critical Section
+ *
+ * Called around the short section in which a log call writes into the
+ * transmit buffer. Define these to mask the interrupts that log or call
+ * logger_transmit_complete(), otherwise a log call from an interrupt that
+ * preempts another log call is dropped with LOGGER_BUSY.
+ */
+#if !defined(LOG_TX_ENTER_CRITICAL)
+#define LOG_TX_ENTER_CRITICAL()
+#define LOG_TX_EXIT_CRITICAL()
+#endif // !defined(LOG_TX_ENTER_CRITICAL)
+
+/**
+ * @brief Log with spans
+ *
+ * Enables CLOG_SCOPE and CLOG_SPAN_BEGIN/END. Spans are recorded with log
+ * level trace and can be exported as Chrome trace event JSON.
+ */
+// #define LOG_WITH_SPANS
+
+/**
+ * @brief Span Buffer
+ *
+ * Number of span events (begin or end) stored per thread.
+ */
+#if !defined(LOG_SPAN_BUFFER_LEN)
+#define LOG_SPAN_BUFFER_LEN     1024U
+#endif // !defined(LOG_SPAN_BUFFER_LEN)
+
+/**
+ * @brief Span Threads
+ *
+ * Maximum number of threads recording spans. Each thread uses one static
+ * span buffer which is not released when the thread exits.
+ */
+#if !defined(LOG_SPAN_THREAD_COUNT)
+#define LOG_SPAN_THREAD_COUNT   4U
+#endif // !defined(LOG_SPAN_THREAD_COUNT)
 
 #ifdef __cplusplus
 }
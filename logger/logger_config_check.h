@@ -21,10 +21,26 @@ extern "C" {
 #endif
 
 
-#if !defined(LOG_WITH_PRINTF)
+#if !defined(LOG_WITH_PRINTF) && !defined(LOG_WITH_TRANSMIT_CALLBACK)
 #error "No print selected"
 #endif
 
+#if defined(LOG_WITH_PRINTF) && defined(LOG_WITH_TRANSMIT_CALLBACK)
+#error "Only one print can be selected"
+#endif
+
+#if defined(LOG_WITH_TRANSMIT_CALLBACK) && (LOG_TX_BUFFER_LEN <= 0u)
+#error "Transmit buffer length must be greater than 0"
+#endif
+
+#if defined(LOG_WITH_SPANS) && (LOG_SPAN_BUFFER_LEN <= 0u)
+#error "Span buffer length must be greater than 0"
+#endif
+
+#if defined(LOG_WITH_SPANS) && (LOG_SPAN_THREAD_COUNT <= 0u)
+#error "Span thread count must be greater than 0"
+#endif
+
 #if defined (BUILD_DEPENDING_LEVELS)
 #if !defined(RELEASE) && !defined(DEBUG) && !defined(TEST)
 #error "No Build Depending Defines"
@@ -0,0 +1,309 @@
+//
+// Created by WART3K on 19.10.26.
+//
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "logger_span.h"
+
+#if defined(LOG_WITH_SPANS)
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#define SPAN_PHASE_BEGIN        'B'
+#define SPAN_PHASE_END          'E'
+#define SPAN_EXPORT_BUFFER_LEN  256U
+#define SPAN_NS_PER_SECOND      1000000000U
+
+typedef struct {
+    const char *name;
+    uint64_t timestamp;
+    char phase;
+} log_span_event_t;
+
+typedef struct {
+    atomic_size_t count;
+    size_t open;
+    log_span_event_t events[LOG_SPAN_BUFFER_LEN];
+} log_span_buffer_t;
+
+#if defined(__unix__) || defined(__APPLE__)
+static uint64_t span_default_timestamp(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * SPAN_NS_PER_SECOND + (uint64_t)ts.tv_nsec;
+}
+#define SPAN_DEFAULT_TIMESTAMP  span_default_timestamp
+#elif defined(_WIN32)
+static uint64_t span_default_timestamp(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    (void)QueryPerformanceFrequency(&frequency);
+    (void)QueryPerformanceCounter(&counter);
+
+    const uint64_t ticks = (uint64_t)counter.QuadPart;
+    const uint64_t ticks_per_second = (uint64_t)frequency.QuadPart;
+    return (ticks / ticks_per_second) * SPAN_NS_PER_SECOND +
+           (ticks % ticks_per_second) * SPAN_NS_PER_SECOND / ticks_per_second;
+}
+#define SPAN_DEFAULT_TIMESTAMP  span_default_timestamp
+#else
+#define SPAN_DEFAULT_TIMESTAMP  NULL
+#endif
+
+static _Atomic(logger_span_timestamp_callback_t) span_timestamp = SPAN_DEFAULT_TIMESTAMP;
+
+static log_span_buffer_t span_buffers[LOG_SPAN_THREAD_COUNT];
+static atomic_size_t span_thread_count = 0U;
+
+static _Thread_local log_span_buffer_t *span_thread_buffer = NULL;
+static _Thread_local bool span_thread_claimed = false;
+static _Thread_local size_t span_thread_skipped = 0U;
+
+static log_span_buffer_t *span_get_thread_buffer(void)
+{
+    if (!span_thread_claimed)
+    {
+        span_thread_claimed = true;
+
+        // slots are never released, threads beyond LOG_SPAN_THREAD_COUNT do not record spans
+        const size_t index = atomic_fetch_add(&span_thread_count, 1U);
+        if (index < LOG_SPAN_THREAD_COUNT)
+        {
+            span_thread_buffer = &span_buffers[index];
+        }
+    }
+
+    return span_thread_buffer;
+}
+
+static logger_status_t span_record(const char *name, const char phase)
+{
+    if (name == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    const logger_span_timestamp_callback_t timestamp = atomic_load(&span_timestamp);
+    if (timestamp == NULL)
+    {
+        return LOGGER_NULL_POINTER_ERROR;
+    }
+
+    log_span_buffer_t *buffer = span_get_thread_buffer();
+    if (buffer == NULL)
+    {
+        return LOGGER_OVERFLOW;
+    }
+
+    // only the owning thread writes, the export reads up to count
+    const size_t count = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+
+    // a begin also reserves the slot for its end, so recorded spans are always closed
+    if (phase == SPAN_PHASE_BEGIN && count + buffer->open + 2U > LOG_SPAN_BUFFER_LEN)
+    {
+        return LOGGER_OVERFLOW;
+    }
+
+    // an end without a recorded begin would be paired with another span
+    if (phase == SPAN_PHASE_END && buffer->open == 0U)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    if (count >= LOG_SPAN_BUFFER_LEN)
+    {
+        return LOGGER_OVERFLOW;
+    }
+
+    buffer->events[count] = (log_span_event_t){
+        .name = name,
+        .timestamp = timestamp(),
+        .phase = phase
+    };
+    atomic_store_explicit(&buffer->count, count + 1U, memory_order_release);
+
+    if (phase == SPAN_PHASE_BEGIN)
+    {
+        buffer->open++;
+    }
+    else
+    {
+        buffer->open--;
+    }
+
+    return LOGGER_STATUS_OK;
+}
+
+logger_status_t logger_set_span_timestamp_callback(const logger_span_timestamp_callback_t timestamp)
+{
+    if (timestamp == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    atomic_store(&span_timestamp, timestamp);
+    return LOGGER_STATUS_OK;
+}
+
+logger_status_t log_span_begin(const char *name)
+{
+    if (name == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    // spans nested in a skipped span are skipped too, so every end matches its begin
+    if (span_thread_skipped > 0U || logger_get_level() < LOG_LEVEL_TRACE)
+    {
+        span_thread_skipped++;
+        return LOGGER_STATUS_OK;
+    }
+
+    const logger_status_t result = span_record(name, SPAN_PHASE_BEGIN);
+    if (result != LOGGER_STATUS_OK)
+    {
+        span_thread_skipped++;
+    }
+
+    return result;
+}
+
+logger_status_t log_span_end(const char *name)
+{
+    if (name == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    // the end of a skipped begin is not recorded, the end of a recorded one regardless of the level
+    if (span_thread_skipped > 0U)
+    {
+        span_thread_skipped--;
+        return LOGGER_STATUS_OK;
+    }
+
+    return span_record(name, SPAN_PHASE_END);
+}
+
+const char *log_span_scope_begin(const char *name)
+{
+    (void)log_span_begin(name);
+    return name;
+}
+
+void log_span_scope_end(const char * const *name)
+{
+    if (name != NULL)
+    {
+        (void)log_span_end(*name);
+    }
+}
+
+static size_t span_escape_name(char *buffer, const size_t buffer_size, const char *name)
+{
+    size_t len = 0U;
+
+    for (const char *c = name; *c != '\0' && len + 2U < buffer_size; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            buffer[len++] = '\\';
+        }
+        else if ((unsigned char)*c < 0x20U)
+        {
+            continue;
+        }
+        buffer[len++] = *c;
+    }
+
+    buffer[len] = '\0';
+    return len;
+}
+
+static logger_status_t span_write_string(const logger_span_write_callback_t write, void *ctx, const char *str)
+{
+    return write(str, strlen(str), ctx);
+}
+
+logger_status_t logger_span_export(const logger_span_write_callback_t write, void *ctx)
+{
+    if (write == NULL)
+    {
+        return LOGGER_WRONG_INPUT_PARAMETER;
+    }
+
+    logger_status_t result = span_write_string(write, ctx, "{\"traceEvents\":[");
+    if (result != LOGGER_STATUS_OK)
+    {
+        return result;
+    }
+
+    const size_t thread_count = atomic_load(&span_thread_count);
+    bool first = true;
+
+    for (size_t t = 0U; t < thread_count && t < LOG_SPAN_THREAD_COUNT; t++)
+    {
+        const log_span_buffer_t *buffer = &span_buffers[t];
+        const size_t count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+
+        for (size_t i = 0U; i < count; i++)
+        {
+            const log_span_event_t *event = &buffer->events[i];
+            char name[SPAN_EXPORT_BUFFER_LEN / 2U];
+            char line[SPAN_EXPORT_BUFFER_LEN];
+
+            (void)span_escape_name(name, sizeof(name), event->name);
+
+            // timestamps are in microseconds
+            const int written = snprintf(line, sizeof(line),
+                                         "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03u,\"pid\":1,\"tid\":%zu}",
+                                         first ? "" : ",",
+                                         name,
+                                         event->phase,
+                                         event->timestamp / 1000U,
+                                         (unsigned int)(event->timestamp % 1000U),
+                                         t + 1U);
+            if (written < 0 || (size_t)written >= sizeof(line))
+            {
+                return LOGGER_FORMAT_ERROR;
+            }
+
+            result = write(line, (size_t)written, ctx);
+            if (result != LOGGER_STATUS_OK)
+            {
+                return result;
+            }
+            first = false;
+        }
+    }
+
+    return span_write_string(write, ctx, "\n]}\n");
+}
+
+void logger_span_reset(void)
+{
+    const size_t thread_count = atomic_load(&span_thread_count);
+
+    for (size_t t = 0U; t < thread_count && t < LOG_SPAN_THREAD_COUNT; t++)
+    {
+        atomic_store(&span_buffers[t].count, 0U);
+        span_buffers[t].open = 0U;
+    }
+}
+
+#endif // defined(LOG_WITH_SPANS)
@@ -0,0 +1,151 @@
+//
+// Created by WART3K on 19.10.26.
+//
+
+#ifndef COOL17_LOGGER_SPAN_H
+#define COOL17_LOGGER_SPAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "logger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(LOG_WITH_SPANS)
+/**
+ * @brief Callback to get the current timestamp.
+ *
+ * @return Monotonic timestamp in nanoseconds.
+ */
+typedef uint64_t (*logger_span_timestamp_callback_t)(void);
+
+/**
+ * @brief Callback to write a part of the exported trace.
+ *
+ * @param data Pointer to the data to write.
+ * @param len Number of bytes to write.
+ * @param ctx User context passed to logger_span_export().
+ * @return LOGGER_STATUS_OK on success, otherwise an error status.
+ */
+typedef logger_status_t (*logger_span_write_callback_t)(const char *data, size_t len, void *ctx);
+
+/**
+ * @brief Sets the timestamp source for the spans.
+ *
+ * A monotonic clock (clock_gettime, QueryPerformanceCounter) is used by
+ * default on Unix, macOS and Windows. On other targets no span is recorded
+ * until a timestamp callback is set.
+ *
+ * @param timestamp The callback returning the current time in nanoseconds.
+ * @return LOGGER_STATUS_OK on success, otherwise an error status.
+ */
+logger_status_t logger_set_span_timestamp_callback(logger_span_timestamp_callback_t timestamp);
+
+/**
+ * @brief Records the begin of a span for the calling thread.
+ *
+ * A begin is only recorded with log level trace and if the buffer also has
+ * room for its end. Spans nested in a begin that was not recorded are not
+ * recorded either. The first LOG_SPAN_THREAD_COUNT threads that record a span
+ * get a buffer, slots are not released when a thread exits.
+ *
+ * @param name Name of the span. Must stay valid until the export (e.g. a string literal).
+ * @return LOGGER_STATUS_OK on success, LOGGER_OVERFLOW if the buffer is full or no
+ *         buffer is left for the thread, otherwise an error status.
+ */
+logger_status_t log_span_begin(const char *name);
+
+/**
+ * @brief Records the end of a span for the calling thread.
+ *
+ * The end is recorded if its begin was recorded, even if the log level
+ * changed in between. The end of a begin that was not recorded is skipped.
+ *
+ * @param name Name of the span. Must stay valid until the export (e.g. a string literal).
+ * @return LOGGER_STATUS_OK on success, LOGGER_WRONG_INPUT_PARAMETER if no span is open,
+ *         otherwise an error status.
+ */
+logger_status_t log_span_end(const char *name);
+
+/**
+ * @brief Begins a span for CLOG_SCOPE.
+ *
+ * @param name Name of the span.
+ * @return The name, passed to log_span_scope_end on scope exit.
+ */
+const char *log_span_scope_begin(const char *name);
+
+/**
+ * @brief Ends a span started by CLOG_SCOPE. Called on scope exit.
+ *
+ * The end is recorded if the begin was, even if the log level changed.
+ *
+ * @param name Pointer to the value returned by log_span_scope_begin.
+ */
+void log_span_scope_end(const char * const *name);
+
+/**
+ * @brief Exports all recorded spans as Chrome trace event JSON.
+ *
+ * The output can be opened in Perfetto or chrome://tracing. Spans recorded
+ * while the export runs may be missing.
+ *
+ * @param write The callback receiving the JSON output.
+ * @param ctx User context passed to the callback.
+ * @return LOGGER_STATUS_OK on success, otherwise an error status.
+ */
+logger_status_t logger_span_export(logger_span_write_callback_t write, void *ctx);
+
+/**
+ * @brief Discards all recorded spans.
+ *
+ * Must not be called while other threads record spans.
+ */
+void logger_span_reset(void);
+
+#define CLOG_SPAN_CONCAT_(a, b)     a##b
+#define CLOG_SPAN_CONCAT(a, b)      CLOG_SPAN_CONCAT_(a, b)
+
+/**
+ * @brief Macro for beginning a span.
+ *
+ * Spans are recorded with log level trace.
+ */
+#define CLOG_SPAN_BEGIN(name)       log_span_begin(name)
+
+/**
+ * @brief Macro for ending a span.
+ *
+ * Must be called with the same name as CLOG_SPAN_BEGIN.
+ */
+#define CLOG_SPAN_END(name)         log_span_end(name)
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief Macro for a span from here to the end of the enclosing scope.
+ *
+ * The span is named after the function.
+ */
+#define CLOG_SCOPE() \
+    const char * const CLOG_SPAN_CONCAT(clog_scope_, __LINE__) \
+    __attribute__((cleanup(log_span_scope_end), unused)) = log_span_scope_begin(__func__)
+#else
+#define CLOG_SCOPE()                ((void)0)
+#endif // defined(__GNUC__) || defined(__clang__)
+
+#else // defined(LOG_WITH_SPANS)
+
+#define CLOG_SPAN_BEGIN(name)       ((void)0)
+#define CLOG_SPAN_END(name)         ((void)0)
+#define CLOG_SCOPE()                ((void)0)
+
+#endif // defined(LOG_WITH_SPANS)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COOL17_LOGGER_SPAN_H
@@ -0,0 +1,320 @@
+//
+// Created by WART3K on 19.10.26.
+//
+
+#define _GNU_SOURCE
+
+#include "logger/logger.h"
+#include "logger/logger_span.h"
+#include "logger/logger_config_check.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TEST_EXPORT_LEN         (1U << 16)
+#define TEST_MAX_EVENTS         (LOG_SPAN_BUFFER_LEN * LOG_SPAN_THREAD_COUNT)
+#define TEST_TIMING_ROUNDS      10000
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return 1;                                                       \
+        }                                                                   \
+    } while (0)
+
+typedef struct {
+    char name[64];
+    char phase;
+    int tid;
+} test_event_t;
+
+typedef struct {
+    char json[TEST_EXPORT_LEN];
+    size_t len;
+    test_event_t events[TEST_MAX_EVENTS];
+    size_t count;
+} test_export_t;
+
+static test_export_t exported;
+
+static logger_status_t export_write(const char *data, const size_t len, void *ctx)
+{
+    test_export_t *out = ctx;
+    if (out->len + len >= sizeof(out->json))
+    {
+        return LOGGER_OVERFLOW;
+    }
+
+    memcpy(&out->json[out->len], data, len);
+    out->len += len;
+    out->json[out->len] = '\0';
+    return LOGGER_STATUS_OK;
+}
+
+/**
+ * Exports the spans and parses the events, one event per line with the name
+ * kept JSON escaped.
+ */
+static int export_and_parse(void)
+{
+    exported.len = 0U;
+    exported.count = 0U;
+    CHECK(logger_span_export(export_write, &exported) == LOGGER_STATUS_OK);
+    CHECK(strncmp(exported.json, "{\"traceEvents\":[", 16) == 0);
+    CHECK(strstr(exported.json, "\n]}\n") != NULL);
+
+    for (const char *line = strstr(exported.json, "\n{\"name\":\""); line != NULL;
+         line = strstr(line + 1, "\n{\"name\":\""))
+    {
+        test_event_t *event = &exported.events[exported.count];
+        const char *name = line + strlen("\n{\"name\":\"");
+        const char *name_end = strstr(name, "\",\"ph\":\"");
+        CHECK(name_end != NULL && (size_t)(name_end - name) < sizeof(event->name));
+        CHECK(exported.count < TEST_MAX_EVENTS);
+
+        memcpy(event->name, name, (size_t)(name_end - name));
+        event->name[name_end - name] = '\0';
+
+        double ts = 0.0;
+        CHECK(sscanf(name_end, "\",\"ph\":\"%c\",\"ts\":%lf,\"pid\":1,\"tid\":%d}",
+                     &event->phase, &ts, &event->tid) == 3);
+        exported.count++;
+    }
+
+    return 0;
+}
+
+static bool event_is(const size_t index, const char *name, const char phase)
+{
+    return index < exported.count &&
+           strcmp(exported.events[index].name, name) == 0 &&
+           exported.events[index].phase == phase;
+}
+
+static void inner(void)
+{
+    CLOG_SCOPE();
+}
+
+static void outer(void)
+{
+    CLOG_SCOPE();
+    (void)CLOG_SPAN_BEGIN("say \"hi\"");
+    inner();
+    (void)CLOG_SPAN_END("say \"hi\"");
+}
+
+static void lowers_level(void)
+{
+    CLOG_SCOPE();
+    (void)logger_set_level(LOG_LEVEL_INFO);
+}
+
+static int test_disabled_below_trace(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_DEBUG);
+
+    outer();
+    CHECK(CLOG_SPAN_BEGIN("disabled") == LOGGER_STATUS_OK);
+    CHECK(CLOG_SPAN_END("disabled") == LOGGER_STATUS_OK);
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == 0U);
+    return 0;
+}
+
+static int test_nested_spans(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    outer();
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == 6U);
+    CHECK(event_is(0U, "outer", 'B'));
+    CHECK(event_is(1U, "say \\\"hi\\\"", 'B'));
+    CHECK(event_is(2U, "inner", 'B'));
+    CHECK(event_is(3U, "inner", 'E'));
+    CHECK(event_is(4U, "say \\\"hi\\\"", 'E'));
+    CHECK(event_is(5U, "outer", 'E'));
+    return 0;
+}
+
+static int test_scope_end_after_level_change(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    lowers_level();
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == 2U);
+    CHECK(event_is(0U, "lowers_level", 'B'));
+    CHECK(event_is(1U, "lowers_level", 'E'));
+    return 0;
+}
+
+static int test_explicit_end_after_level_change(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    CHECK(CLOG_SPAN_BEGIN("lowered") == LOGGER_STATUS_OK);
+    (void)logger_set_level(LOG_LEVEL_INFO);
+    CHECK(CLOG_SPAN_END("lowered") == LOGGER_STATUS_OK);
+
+    // spans nested in a begin below trace level are skipped with it
+    CHECK(CLOG_SPAN_BEGIN("raised") == LOGGER_STATUS_OK);
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+    CHECK(CLOG_SPAN_BEGIN("nested") == LOGGER_STATUS_OK);
+    inner();
+    CHECK(CLOG_SPAN_END("nested") == LOGGER_STATUS_OK);
+    CHECK(CLOG_SPAN_END("raised") == LOGGER_STATUS_OK);
+
+    CHECK(CLOG_SPAN_BEGIN("after") == LOGGER_STATUS_OK);
+    CHECK(CLOG_SPAN_END("after") == LOGGER_STATUS_OK);
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == 4U);
+    CHECK(event_is(0U, "lowered", 'B'));
+    CHECK(event_is(1U, "lowered", 'E'));
+    CHECK(event_is(2U, "after", 'B'));
+    CHECK(event_is(3U, "after", 'E'));
+    return 0;
+}
+
+static int test_full_buffer_stays_balanced(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    size_t depth = 0U;
+    logger_status_t result = LOGGER_STATUS_OK;
+    while ((result = CLOG_SPAN_BEGIN("deep")) == LOGGER_STATUS_OK)
+    {
+        depth++;
+    }
+    CHECK(result == LOGGER_OVERFLOW);
+    CHECK(depth == LOG_SPAN_BUFFER_LEN / 2U);
+
+    // keep using spans after the failed begin, none of them may take an outer end slot
+    CHECK(CLOG_SPAN_BEGIN("skipped") == LOGGER_STATUS_OK);
+    inner();
+    CHECK(CLOG_SPAN_END("skipped") == LOGGER_STATUS_OK);
+    CHECK(CLOG_SPAN_END("deep") == LOGGER_STATUS_OK);
+
+    for (size_t i = 0U; i < depth; i++)
+    {
+        CHECK(CLOG_SPAN_END("deep") == LOGGER_STATUS_OK);
+    }
+
+    CHECK(CLOG_SPAN_END("stray") == LOGGER_WRONG_INPUT_PARAMETER);
+    CHECK(CLOG_SPAN_BEGIN("full") == LOGGER_OVERFLOW);
+    CHECK(CLOG_SPAN_END("full") == LOGGER_STATUS_OK);
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == LOG_SPAN_BUFFER_LEN);
+    for (size_t i = 0U; i < exported.count; i++)
+    {
+        CHECK(event_is(i, "deep", (i < depth) ? 'B' : 'E'));
+    }
+    return 0;
+}
+
+static void *record_thread(void *arg)
+{
+    logger_status_t *result = arg;
+    *result = CLOG_SPAN_BEGIN("thread");
+    if (*result == LOGGER_STATUS_OK)
+    {
+        *result = CLOG_SPAN_END("thread");
+    }
+    return NULL;
+}
+
+static int test_thread_slots(void)
+{
+    logger_span_reset();
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    // the main thread already owns the first slot
+    logger_status_t results[LOG_SPAN_THREAD_COUNT];
+    for (size_t i = 0U; i < LOG_SPAN_THREAD_COUNT; i++)
+    {
+        pthread_t thread;
+        CHECK(pthread_create(&thread, NULL, record_thread, &results[i]) == 0);
+        CHECK(pthread_join(thread, NULL) == 0);
+    }
+
+    for (size_t i = 0U; i + 1U < LOG_SPAN_THREAD_COUNT; i++)
+    {
+        CHECK(results[i] == LOGGER_STATUS_OK);
+    }
+    CHECK(results[LOG_SPAN_THREAD_COUNT - 1U] == LOGGER_OVERFLOW);
+
+    CHECK(export_and_parse() == 0);
+    CHECK(exported.count == 2U * (LOG_SPAN_THREAD_COUNT - 1U));
+    for (size_t i = 0U; i < exported.count; i++)
+    {
+        CHECK(exported.events[i].tid == (int)(i / 2U) + 2);
+    }
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int test_event_cost(void)
+{
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+
+    double total = 0.0;
+    for (int round = 0; round < TEST_TIMING_ROUNDS; round++)
+    {
+        logger_span_reset();
+        const double start = now_ns();
+        inner();
+        total += now_ns() - start;
+    }
+    const double enabled = total / (2.0 * TEST_TIMING_ROUNDS);
+
+    (void)logger_set_level(LOG_LEVEL_DEBUG);
+    const double start = now_ns();
+    for (int round = 0; round < TEST_TIMING_ROUNDS; round++)
+    {
+        inner();
+    }
+    const double disabled = (now_ns() - start) / (2.0 * TEST_TIMING_ROUNDS);
+
+    printf("span event: %.1f ns recorded, %.1f ns below trace level\n", enabled, disabled);
+
+    // generous bound, the cost is dominated by the clock
+    CHECK(enabled < 1000.0);
+    CHECK(disabled < enabled);
+    return 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+    failed += test_disabled_below_trace();
+    failed += test_nested_spans();
+    failed += test_scope_end_after_level_change();
+    failed += test_explicit_end_after_level_change();
+    failed += test_full_buffer_stays_balanced();
+    failed += test_thread_slots();
+    failed += test_event_cost();
+
+    printf("%s\n", failed == 0 ? "all tests passed" : "tests failed");
+    return failed == 0 ? 0 : 1;
+}
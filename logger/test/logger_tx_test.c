@@ -0,0 +1,282 @@
+//
+// Created by WART3K on 19.10.26.
+//
+
+#define _GNU_SOURCE
+
+#include "logger/logger.h"
+#include "logger/logger_config_check.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TEST_MESSAGE_COUNT      200
+#define TEST_TIMING_ROUNDS      4
+#define TEST_TIMING_BURST       6
+#define TEST_OUTPUT_LEN         (1U << 20)
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return 1;                                                       \
+        }                                                                   \
+    } while (0)
+
+/**
+ * Simulated UART: transmits one buffer at a time and calls the completion
+ * hook after the time the bytes need at the configured baud rate. In manual
+ * mode the test calls the completion hook itself.
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_cond_t idle;
+    size_t started;
+    size_t completed;
+    const char *data;
+    size_t len;
+    long baud;
+    bool manual;
+    char output[TEST_OUTPUT_LEN];
+    size_t output_len;
+} uart_sim_t;
+
+static uart_sim_t uart = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+    .idle = PTHREAD_COND_INITIALIZER
+};
+
+static logger_status_t uart_transmit(const char *data, const size_t len)
+{
+    pthread_mutex_lock(&uart.mutex);
+    if (uart.output_len + len <= sizeof(uart.output))
+    {
+        memcpy(&uart.output[uart.output_len], data, len);
+        uart.output_len += len;
+    }
+    uart.data = data;
+    uart.len = len;
+    uart.started++;
+    pthread_cond_signal(&uart.cond);
+    pthread_mutex_unlock(&uart.mutex);
+    return LOGGER_STATUS_OK;
+}
+
+static void uart_complete(void)
+{
+    // the hook may start the next transfer before the completion is counted
+    logger_transmit_complete();
+
+    pthread_mutex_lock(&uart.mutex);
+    uart.completed++;
+    pthread_cond_broadcast(&uart.idle);
+    pthread_mutex_unlock(&uart.mutex);
+}
+
+static void *uart_thread(void *arg)
+{
+    (void)arg;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&uart.mutex);
+        while (uart.data == NULL || uart.manual)
+        {
+            pthread_cond_wait(&uart.cond, &uart.mutex);
+        }
+        // 10 bits per byte: start, 8 data, stop
+        const long long duration_ns = (long long)uart.len * 10LL * 1000000000LL / uart.baud;
+        uart.data = NULL;
+        pthread_mutex_unlock(&uart.mutex);
+
+        const struct timespec ts = {
+            .tv_sec = (time_t)(duration_ns / 1000000000LL),
+            .tv_nsec = (long)(duration_ns % 1000000000LL)
+        };
+        nanosleep(&ts, NULL);
+        uart_complete();
+    }
+
+    return NULL;
+}
+
+static void uart_reset(const long baud, const bool manual)
+{
+    pthread_mutex_lock(&uart.mutex);
+    uart.baud = baud;
+    uart.manual = manual;
+    uart.data = NULL;
+    uart.output_len = 0U;
+    pthread_mutex_unlock(&uart.mutex);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void wait_idle(void)
+{
+    pthread_mutex_lock(&uart.mutex);
+    while (uart.started != uart.completed)
+    {
+        pthread_cond_wait(&uart.idle, &uart.mutex);
+    }
+    pthread_mutex_unlock(&uart.mutex);
+}
+
+static int test_order_without_drops(void)
+{
+    uart_reset(2000000, false);
+
+    for (int i = 0; i < TEST_MESSAGE_COUNT; i++)
+    {
+        CHECK(CLOGI("message %d\n", i) == LOGGER_STATUS_OK);
+        usleep(500);
+    }
+    wait_idle();
+
+    char expected[TEST_OUTPUT_LEN / 4U];
+    size_t expected_len = 0U;
+    for (int i = 0; i < TEST_MESSAGE_COUNT; i++)
+    {
+        expected_len += (size_t)snprintf(&expected[expected_len], sizeof(expected) - expected_len,
+                                         "[INFO    ]: test_order_without_drops: message %d\n", i);
+    }
+
+    pthread_mutex_lock(&uart.mutex);
+    const bool equal = uart.output_len == expected_len && memcmp(uart.output, expected, expected_len) == 0;
+    pthread_mutex_unlock(&uart.mutex);
+    CHECK(equal);
+    return 0;
+}
+
+static int test_busy_and_overflow(void)
+{
+    uart_reset(2000000, true);
+
+    // the first message is transmitted, the next ones fill the other buffer
+    CHECK(CLOGI("first\n") == LOGGER_STATUS_OK);
+
+    logger_status_t result = LOGGER_STATUS_OK;
+    int accepted = 0;
+    while (result == LOGGER_STATUS_OK && (size_t)accepted < LOG_TX_BUFFER_LEN)
+    {
+        result = CLOGI("filling the second buffer %d\n", accepted);
+        accepted += (result == LOGGER_STATUS_OK) ? 1 : 0;
+    }
+    CHECK(result == LOGGER_BUSY);
+    CHECK(accepted > 0);
+
+    char too_long[LOG_TX_BUFFER_LEN + 88U];
+    memset(too_long, 'x', sizeof(too_long) - 1U);
+    too_long[sizeof(too_long) - 1U] = '\0';
+
+    // complete the first transfer, the second buffer is started and the first one is free
+    uart_complete();
+    CHECK(CLOGI("%s", too_long) == LOGGER_OVERFLOW);
+
+    pthread_mutex_lock(&uart.mutex);
+    uart.manual = false;
+    pthread_cond_signal(&uart.cond);
+    pthread_mutex_unlock(&uart.mutex);
+    wait_idle();
+
+    CHECK(CLOGI("after\n") == LOGGER_STATUS_OK);
+    wait_idle();
+
+    pthread_mutex_lock(&uart.mutex);
+    const bool ends_with_after = uart.output_len > 6U &&
+        memcmp(&uart.output[uart.output_len - 6U], "after\n", 6U) == 0;
+    pthread_mutex_unlock(&uart.mutex);
+    CHECK(ends_with_after);
+    return 0;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    const double lhs = *(const double *)a;
+    const double rhs = *(const double *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * Logs bursts that fit into one buffer while the first message of the burst
+ * is transmitted, so every call writes its message. Returns the median time
+ * of the calls or a negative value if a message was dropped.
+ */
+static double measure_call_ns(const long baud)
+{
+    double samples[TEST_TIMING_ROUNDS * TEST_TIMING_BURST];
+    size_t count = 0U;
+
+    uart_reset(baud, false);
+
+    for (int round = 0; round < TEST_TIMING_ROUNDS; round++)
+    {
+        for (int i = 0; i < TEST_TIMING_BURST; i++)
+        {
+            const double start = now_ns();
+            const logger_status_t result = CLOGI("timing message %d at %ld baud\n", i, baud);
+            const double duration = now_ns() - start;
+
+            if (result != LOGGER_STATUS_OK)
+            {
+                wait_idle();
+                return -1.0;
+            }
+            samples[count++] = duration;
+        }
+        wait_idle();
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_double);
+    return samples[count / 2U];
+}
+
+static int test_time_independent_of_baud(void)
+{
+    const double slow = measure_call_ns(9600);
+    const double fast = measure_call_ns(2000000);
+
+    printf("CLOGI: %.0f ns at 9600 baud, %.0f ns at 2000000 baud\n", slow, fast);
+
+    CHECK(slow > 0.0);
+    CHECK(fast > 0.0);
+
+    // a blocking output would be about 200 times slower at 9600 baud
+    CHECK(slow < fast * 5.0);
+    return 0;
+}
+
+int main(void)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, uart_thread, NULL) != 0)
+    {
+        return 1;
+    }
+
+    (void)logger_set_level(LOG_LEVEL_TRACE);
+    if (logger_set_transmit_callback(uart_transmit) != LOGGER_STATUS_OK)
+    {
+        return 1;
+    }
+
+    int failed = 0;
+    failed += test_order_without_drops();
+    failed += test_busy_and_overflow();
+    failed += test_time_independent_of_baud();
+
+    printf("%s\n", failed == 0 ? "all tests passed" : "tests failed");
+    return failed == 0 ? 0 : 1;
+}